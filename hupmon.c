@@ -5,7 +5,7 @@
  * between terminals that use software flow control and applications that do
  * not support it.
  *
- * - Make: `c99 -O1 -lutil -D_DEFAULT_SOURCE -o $@ $?`
+ * - Make: `c99 -O1 -lutil -D_GNU_SOURCE -o $@ $?`
  */
 #include <errno.h>
 #include <fcntl.h>
@@ -15,10 +15,15 @@
 #include <poll.h>
 #include <pty.h>
 #include <signal.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <termios.h>
 #include <time.h>
@@ -62,6 +67,46 @@
  */
 #define CPRSIZE 10
 
+/**
+ * Length of the buffer used to hold a session's reply to a status query. This
+ * is enough for a device state followed by a round-trip time printed with
+ * "%.6f".
+ */
+#define STATUSSIZE 64
+
+/**
+ * Maximum number of pending connections on a status socket. This is also the
+ * most status queries a session will answer before returning its attention to
+ * the terminal.
+ */
+#define STATUSBACKLOG 8
+
+/**
+ * Amount of time in seconds a one-shot query waits for a session's reply.
+ * Sessions answer status queries while waiting for replies to their own
+ * queries, so this does not depend on their reply timeouts; it only needs to
+ * cover brief stalls like writes to a terminal that is draining its output.
+ */
+#define STATUSTIMEOUT 1.0
+
+/**
+ * Reply sent by a session to peers that are not allowed to know the state of
+ * the terminal.
+ */
+#define STATUS_REFUSED "REFUSED\n"
+
+/**
+ * Maximum number of supplementary groups of a peer that are considered when
+ * deciding whether it may know the state of a terminal. When a peer belongs to
+ * more groups than this, only its primary group is considered.
+ */
+#define MAXPEERGROUPS 256
+
+/**
+ * Major device number of "/dev/tty".
+ */
+#define TTYAUX_MAJOR 5
+
 /**
  * The program was launched using invalid command line arguments.
  */
@@ -143,6 +188,25 @@ typedef enum {
     ACTION_ONE_SHOT_QUERY,
 } action_et;
 
+/**
+ * Possible outcomes of asking a running session for the state of a terminal.
+ */
+typedef enum {
+    SESSION_ABSENT,
+    SESSION_SILENT,
+    SESSION_REFUSED,
+    SESSION_ANSWERED,
+} session_query_et;
+
+/**
+ * State of a terminal as published by a session through its status socket.
+ */
+typedef struct {
+    int fd;                 // Listening status socket descriptor or -1.
+    device_state_et state;  // Current state of the terminal.
+    double rtt;             // Round-trip time of the last successful query.
+} status_socket_st;
+
 /**
  * This variable is set to a non-zero value when this program receives a
  * SIGWINCH signal.
@@ -232,6 +296,219 @@ static double timer(void)
     return (double) ts.tv_sec + ts.tv_nsec / 1.0E9;
 }
 
+/**
+ * Generate the address of the status socket for a terminal. The address is in
+ * the Linux abstract socket namespace, so nothing is left behind on the file
+ * system if the program is killed, and it is derived from the device number
+ * instead of the path so "/dev/tty" and the terminal's real path produce the
+ * same address.
+ *
+ * Arguments:
+ * - ttyfd: TTY file descriptor.
+ * - addr: The generated address is stored in this structure.
+ * - length: The number of meaningful bytes in the address is stored where this
+ *   argument points.
+ *
+ * Returns: 0 is returned if the address was generated, and a non-zero value is
+ * returned otherwise.
+ */
+static int status_socket_address(int ttyfd, struct sockaddr_un *addr,
+  socklen_t *length)
+{
+    unsigned int device;
+    int size;
+    struct stat st;
+
+    // TIOCGDEV resolves "/dev/tty" to the device it refers to, but it is only
+    // available on Linux 3.5 and newer. Without it, every controlling terminal
+    // opened through "/dev/tty" has the same device number, so no address is
+    // generated for it.
+    if (ioctl(ttyfd, TIOCGDEV, &device)) {
+        if (fstat(ttyfd, &st) ||
+          (major(st.st_rdev) == TTYAUX_MAJOR && minor(st.st_rdev) == 0)) {
+            return -1;
+        }
+
+        device = (unsigned int) st.st_rdev;
+    }
+
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    size = snprintf(addr->sun_path + 1, sizeof(addr->sun_path) - 1,
+        NAME "/%u", device);
+
+    if (size < 0) {
+        return -1;
+    }
+
+    *length = (socklen_t) (offsetof(struct sockaddr_un, sun_path) + 1 +
+        (size_t) size);
+    return 0;
+}
+
+/**
+ * Determine if the process at the other end of a connected Unix domain socket
+ * should be trusted to exchange terminal states. Root and the effective user of
+ * this process are trusted.
+ *
+ * Returns: If the peer is trusted, 1 is returned. Otherwise, 0 is.
+ */
+static int trusted_peer(int fd)
+{
+    struct ucred cred;
+
+    socklen_t credsize = sizeof(cred);
+
+    return (
+        !getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &credsize) &&
+        (cred.uid == 0 || cred.uid == geteuid())
+    );
+}
+
+/**
+ * Determine if the process at the other end of a connected Unix domain socket
+ * could open a terminal for reading and writing based on the terminal's owner,
+ * group and mode. Those are the processes that could query the terminal
+ * directly, so they may also know its state.
+ *
+ * Arguments:
+ * - fd: Connected socket descriptor.
+ * - ttyfd: TTY file descriptor.
+ *
+ * Returns: If the peer could open the terminal, 1 is returned. Otherwise, 0 is.
+ */
+static int peer_can_open_tty(int fd, int ttyfd)
+{
+    struct ucred cred;
+    int n;
+    struct stat st;
+
+#ifdef SO_PEERGROUPS
+    gid_t groups[MAXPEERGROUPS];
+    socklen_t groupsize = sizeof(groups);
+#endif
+
+    socklen_t credsize = sizeof(cred);
+    int in_group = 0;
+    mode_t rw = S_IROTH | S_IWOTH;
+
+    // The owner, group and mode of "/dev/tty" say nothing about the terminal
+    // it refers to, so only trusted peers are answered in that case.
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &credsize) ||
+      fstat(ttyfd, &st) ||
+      (major(st.st_rdev) == TTYAUX_MAJOR && minor(st.st_rdev) == 0)) {
+        return 0;
+    } else if (cred.uid == 0) {
+        return 1;
+    } else if (cred.uid == st.st_uid) {
+        return (st.st_mode & (S_IRUSR | S_IWUSR)) == (S_IRUSR | S_IWUSR);
+    }
+
+    in_group = (cred.gid == st.st_gid);
+
+#ifdef SO_PEERGROUPS
+    // Supplementary groups matter because users are usually given access to
+    // serial ports through a group like "dialout". This requires Linux 4.13.
+    if (!in_group &&
+      !getsockopt(fd, SOL_SOCKET, SO_PEERGROUPS, groups, &groupsize)) {
+        for (n = 0; n < (int) (groupsize / sizeof(*groups)); n++) {
+            if (groups[n] == st.st_gid) {
+                in_group = 1;
+                break;
+            }
+        }
+    }
+#else
+    /* Unused: */ (void) n;
+#endif
+
+    if (in_group) {
+        rw = S_IRGRP | S_IWGRP;
+    }
+
+    return (st.st_mode & rw) == rw;
+}
+
+/**
+ * Create the socket used to answer status queries about a terminal from other
+ * instances of HUPMon. This is best-effort: failure to create the socket,
+ * including another process already holding the address, is not an error.
+ *
+ * Arguments:
+ * - ttyfd: TTY file descriptor.
+ *
+ * Returns: A listening socket descriptor or -1 if the socket could not be
+ * created.
+ */
+static int open_status_socket(int ttyfd)
+{
+    struct sockaddr_un addr;
+    int fd;
+    socklen_t length;
+
+    if (status_socket_address(ttyfd, &addr, &length) ||
+      (fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)) ==
+      -1) {
+        return -1;
+    }
+
+    if (bind(fd, (struct sockaddr *) &addr, length) ||
+      listen(fd, STATUSBACKLOG)) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/**
+ * Accept connections on the status socket and send the state of the terminal.
+ * Peers that are neither trusted nor able to open the terminal are sent
+ * `STATUS_REFUSED` instead. At most `STATUSBACKLOG` connections are handled per
+ * call so a flood of connections cannot starve the terminal of attention.
+ * Errors are ignored since they only affect the querying process.
+ *
+ * Arguments:
+ * - ttyfd: TTY file descriptor.
+ * - status: Status socket and the state it publishes. If this is NULL or the
+ *   socket descriptor is -1, this function does nothing.
+ */
+static void answer_status_query(int ttyfd, const status_socket_st *status)
+{
+    char message[STATUSSIZE];
+    int clientfd;
+    int n;
+    int size;
+
+    if (!status || status->fd == -1) {
+        return;
+    }
+
+    size = snprintf(message, sizeof(message), "%d %.6f\n", status->state,
+        status->rtt);
+
+    for (n = 0; n < STATUSBACKLOG; n++) {
+        if ((clientfd = accept(status->fd, NULL, NULL)) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            break;
+        }
+
+        if (trusted_peer(clientfd) || peer_can_open_tty(clientfd, ttyfd)) {
+            if (size > 0) {
+                send(clientfd, message, (size_t) size, MSG_NOSIGNAL);
+            }
+        } else {
+            send(clientfd, STATUS_REFUSED, sizeof(STATUS_REFUSED) - 1,
+                MSG_NOSIGNAL);
+        }
+
+        close(clientfd);
+    }
+}
+
 /**
  * Determine if there is an online terminal at the receiving end of a TTY file
  * descriptor. A Cursor Position Report (CPR) control sequence is written to
@@ -252,6 +529,9 @@ static double timer(void)
  *   value must be at least 10 milliseconds (0.01). If this function reports
  *   that a terminal is offline when it is not, it may not be responding to the
  *   query fast enough, and increasing this value may resolve the issue.
+ * - status: When this is not NULL, status queries that are pending or arrive
+ *   while waiting for the reply are answered with the state from before this
+ *   query so they are not held up by slow terminals.
  *
  * Returns:
  * - DEVICE_STATUS_UNKNOWN: There was an error. This could be due to a failing
@@ -261,7 +541,8 @@ static double timer(void)
  *   terminal is considered to be online even when the CPR response was
  *   malformed.
  */
-static int ping_tty(int ttyfd, char *reply, ssize_t *length, double cprtimeout)
+static int ping_tty(int ttyfd, char *reply, ssize_t *length, double cprtimeout,
+  const status_socket_st *status)
 {
     struct termios tty_attr;
     char byte;
@@ -280,11 +561,21 @@ static int ping_tty(int ttyfd, char *reply, ssize_t *length, double cprtimeout)
     char *eom = reply;
     device_state_et state = DEVICE_STATUS_UNKNOWN;
 
-    struct pollfd pfd = {
-        .events = POLLIN,
-        .fd = ttyfd,
+    struct pollfd pfds[2] = {
+        {
+            .events = POLLIN,
+            .fd = ttyfd,
+        },
+        {
+            .events = POLLIN,
+            .fd = status ? status->fd : -1,
+        },
     };
 
+    // Queries that are already pending are answered before touching the
+    // terminal since writing the CPR may block.
+    answer_status_query(ttyfd, status);
+
     if (tcgetattr(ttyfd, &tty_attr)) {
         goto done;
     } else {
@@ -304,9 +595,17 @@ static int ping_tty(int ttyfd, char *reply, ssize_t *length, double cprtimeout)
     deadline = timer() + cprtimeout;
 
     while ((polltimeoutms = (int) (1000 * (deadline - timer()))) > 0) {
-        pending = poll(&pfd, 1, polltimeoutms);
+        pending = poll(pfds, 2, polltimeoutms);
+
+        if (pending > 0 && pfds[1].revents) {
+            answer_status_query(ttyfd, status);
+
+            if (!pfds[0].revents) {
+                continue;
+            }
+        }
 
-        if (pending <= 0 || !PFDALIVE(pfd)) {
+        if (pending <= 0 || !PFDALIVE(pfds[0])) {
             if (pending == -1 && errno == EINTR) {
                 continue;
             } else if (pending == -1) {
@@ -382,6 +681,107 @@ done:
     return state;
 }
 
+/**
+ * Ask a running HUPMon session that owns a terminal for the terminal's state.
+ * Nothing is sent to the terminal, so this is safe to use while another process
+ * is using it. Sessions run by users other than root or the effective user of
+ * this process are ignored.
+ *
+ * Arguments:
+ * - ttyfd: TTY file descriptor.
+ * - state: If a session answered, the terminal's state is stored here.
+ * - rtt: If a session answered, the round-trip time in seconds of its most
+ *   recent successful query or a negative number is stored here.
+ * - timeout: Amount of time in seconds to wait for a reply from the session.
+ *
+ * Returns:
+ * - SESSION_ABSENT: No trusted session is running on the terminal.
+ * - SESSION_SILENT: A session is running on the terminal, but it did not send
+ *   a valid reply in time. The terminal must not be queried directly.
+ * - SESSION_REFUSED: A session is running on the terminal, but this process is
+ *   not allowed to know the terminal's state.
+ * - SESSION_ANSWERED: The session answered the query.
+ */
+static session_query_et query_session(int ttyfd, device_state_et *state,
+  double *rtt, double timeout)
+{
+    struct sockaddr_un addr;
+    double deadline;
+    int fd;
+    socklen_t length;
+    char message[STATUSSIZE];
+    int pending;
+    int polltimeoutms;
+    ssize_t received;
+    int remote_state;
+    double remote_rtt;
+
+    session_query_et result = SESSION_ABSENT;
+    ssize_t total = 0;
+
+    struct pollfd pfd = {
+        .events = POLLIN,
+    };
+
+    if (status_socket_address(ttyfd, &addr, &length) ||
+      (fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)) ==
+      -1) {
+        return result;
+    }
+
+    pfd.fd = fd;
+
+    // A full backlog means something is listening on the address but is too
+    // busy to accept connections, so it is treated like a silent session.
+    if (connect(fd, (struct sockaddr *) &addr, length)) {
+        if (errno == EAGAIN) {
+            result = SESSION_SILENT;
+        }
+
+        goto done;
+    } else if (!trusted_peer(fd)) {
+        goto done;
+    }
+
+    result = SESSION_SILENT;
+    deadline = timer() + timeout;
+
+    while (total < (ssize_t) sizeof(message) - 1 &&
+      (polltimeoutms = (int) (1000 * (deadline - timer()))) > 0) {
+        pending = poll(&pfd, 1, polltimeoutms);
+
+        if (pending == -1 && errno == EINTR) {
+            continue;
+        } else if (pending <= 0) {
+            break;
+        }
+
+        if ((received = read(fd, message + total,
+          sizeof(message) - 1 - (size_t) total)) > 0) {
+            total += received;
+        } else if (received == 0 || errno != EINTR) {
+            break;
+        }
+    }
+
+    message[total] = '\0';
+
+    if (!strcmp(message, STATUS_REFUSED)) {
+        result = SESSION_REFUSED;
+    } else if (sscanf(message, "%d %lf", &remote_state, &remote_rtt) == 2 &&
+        remote_state >= DEVICE_STATUS_UNKNOWN &&
+        remote_state <= DEVICE_ONLINE) {
+
+        *state = (device_state_et) remote_state;
+        *rtt = remote_rtt;
+        result = SESSION_ANSWERED;
+    }
+
+done:
+    close(fd);
+    return result;
+}
+
 /**
  * Act as a proxy between the controlling terminal and the specified command to
  * provide two services: detecting when a terminal is no longer transmitting or
@@ -399,6 +799,10 @@ done:
  * - cprtimeout: Minimum amount of time to wait for a reply. Refer to the
  *   "ping_tty" function for more details.
  *
+ * While the command is running, the state of the terminal and the round-trip
+ * time of the last query are made available to "query_session" so one-shot
+ * queries do not have to compete with this function for the terminal's input.
+ *
  * Returns: The exit status of the child process or -1 if the child process was
  * never executed.
  */
@@ -410,6 +814,7 @@ static int wrap(int ttyfd, char **argv, double timeout, double cprtimeout)
     struct sigaction old_sigwinch_sa;
     struct termios old_tty_attr;
     int pending;
+    double sent;
     struct winsize size;
     struct termios tty_attr;
     int wait_status;
@@ -419,14 +824,26 @@ static int wrap(int ttyfd, char **argv, double timeout, double cprtimeout)
     ssize_t received = 0;
     int return_code = -1;
     double start = 0;
-    device_state_et state = DEVICE_OFFLINE;
     int txok = 1;
 
-    struct pollfd pfds[2] = {
+    // The state reported to status queries is unknown until the terminal
+    // answers a query or sends input. In flow-control-only mode, the terminal
+    // is never queried, so the state remains unknown.
+    status_socket_st status = {
+        .fd = -1,
+        .state = DEVICE_STATUS_UNKNOWN,
+        .rtt = -1,
+    };
+
+    struct pollfd pfds[3] = {
         {
             .fd = ttyfd,
             .events = POLLIN,
         },
+        {
+            .fd = -1,  // Negative descriptors are ignored by poll(2).
+            .events = POLLIN,
+        },
         {
             .fd = INT_MAX,  // Default of 0 is likely to be a valid descriptor.
             .events = POLLIN,
@@ -471,7 +888,8 @@ static int wrap(int ttyfd, char **argv, double timeout, double cprtimeout)
         _exit(return_code);
 
       default:
-        pfds[1].fd = childfd;
+        pfds[1].fd = status.fd = open_status_socket(ttyfd);
+        pfds[2].fd = childfd;
     }
 
     while (1) {
@@ -485,19 +903,25 @@ static int wrap(int ttyfd, char **argv, double timeout, double cprtimeout)
             start = timer();
         }
 
-        if (!(pending = poll(pfds, txok ? 2 : 1, polltimeoutms))) {
+        if (!(pending = poll(pfds, txok ? 3 : 2, polltimeoutms))) {
             // The polling timed out.
             if (txok) {
-                state = ping_tty(ttyfd, buffer, &received, cprtimeout);
+                sent = timer();
+                status.state = ping_tty(ttyfd, buffer, &received, cprtimeout,
+                    &status);
+
+                if (status.state == DEVICE_ONLINE) {
+                    status.rtt = timer() - sent;
+                }
 
                 if (received > 0) {
                     write(childfd, buffer, (size_t) received);
                 }
             } else {
-                state = DEVICE_OFFLINE;
+                status.state = DEVICE_OFFLINE;
             }
 
-            if (state == DEVICE_OFFLINE) {
+            if (status.state == DEVICE_OFFLINE) {
                 timeout = -1;
                 polltimeoutms = -1;
                 while (close(childfd) && errno == EINTR);
@@ -508,12 +932,27 @@ static int wrap(int ttyfd, char **argv, double timeout, double cprtimeout)
             // Input from the terminal and/or output from the program is
             // available to be processed or one of the descriptors is no longer
             // valid.
+            if (pfds[1].revents) {
+                answer_status_query(ttyfd, &status);
+                pfds[1].revents = 0;
+
+                // Status queries are not terminal activity, so they must not
+                // postpone the next query sent to the terminal.
+                if (timeout >= 0) {
+                    polltimeoutms -= (int) (1000 * (timer() - start));
+                }
+            }
+
             if (pfds[0].revents) {
                 if (!PFDALIVE(pfds[0]) ||
                   (received = read(ttyfd, buffer, sizeof(buffer))) <= 0) {
                     break;
                 }
 
+                if (timeout >= 0) {
+                    status.state = DEVICE_ONLINE;
+                }
+
                 tcgetattr(ttyfd, &tty_attr);
 
                 if (tty_attr.c_iflag & IXOFF) {
@@ -531,15 +970,15 @@ static int wrap(int ttyfd, char **argv, double timeout, double cprtimeout)
                 pfds[0].revents = 0;
             }
 
-            if (!PFDALIVE(pfds[1])) {
+            if (!PFDALIVE(pfds[2])) {
                 break;
-            } else if (txok && pfds[1].revents) {
+            } else if (txok && pfds[2].revents) {
                 if ((received = read(childfd, buffer, sizeof(buffer))) <= 0) {
                     break;
                 }
 
                 write(ttyfd, buffer, (size_t) received);
-                pfds[1].revents = 0;
+                pfds[2].revents = 0;
             }
         } else if (errno != EINTR) {
             // The only expected error from poll(2) is EINTR presumably from
@@ -570,6 +1009,10 @@ static int wrap(int ttyfd, char **argv, double timeout, double cprtimeout)
     errno_copy = errno_copy ? errno_copy : errno;
     close(childfd);
 
+    if (status.fd != -1) {
+        close(status.fd);
+    }
+
     if (waitpid(child, &wait_status, 0) == -1) {
         return_code = -1;  // This should be unreachable.
     } else if (WIFEXITED(wait_status)) {
@@ -593,12 +1036,17 @@ done:
 }
 
 /**
- * Check the status of a terminal and print its state.
+ * Check the status of a terminal and print its state. If a HUPMon session is
+ * running on the terminal, the session is asked for the state instead of
+ * querying the terminal directly, so the session's input is left untouched. A
+ * session that does not answer is reported as "DEVICE_STATUS_UNKNOWN".
  *
  * Arguments:
  * - ttyfd: TTY file descriptor.
  * - cprtimeout: Minimum amount of time to wait for a reply. Refer to the
  *   "ping_tty" function for more details.
+ * - show_rtt: When this is non-zero and the round-trip time of a query is
+ *   known, it is printed in seconds on a second line as "RTT=SECONDS".
  *
  * Returns:
  * - -1: An unrecoverable error occurred while retrieving or adjusting the
@@ -606,19 +1054,45 @@ done:
  * - 0: This function was able to call the "ping_tty" function, but that does
  *   **not** mean there were no errors during the call.
  */
-static int print_tty_status(int ttyfd, double cprtimeout)
+static int print_tty_status(int ttyfd, double cprtimeout, int show_rtt)
 {
     const char *message;
     char reply[CPRSIZE];
     int result;
+    double sent;
+    device_state_et state;
 
     int errno_copy = 0;
+    double rtt = -1;
+
+    switch (query_session(ttyfd, &state, &rtt, STATUSTIMEOUT)) {
+      case SESSION_ABSENT:
+        sent = timer();
+        state = ping_tty(ttyfd, reply, NULL, cprtimeout, NULL);
+
+        if (state == DEVICE_STATUS_UNKNOWN) {
+            errno_copy = errno;
+            xerror("unable to query the terminal");
+        } else if (state == DEVICE_ONLINE) {
+            rtt = timer() - sent;
+        }
+
+        break;
+      case SESSION_SILENT:
+        state = DEVICE_STATUS_UNKNOWN;
+        errorf("the session using the terminal did not answer");
+        break;
+      case SESSION_REFUSED:
+        state = DEVICE_STATUS_UNKNOWN;
+        errorf("the session using the terminal refused the query");
+        break;
+      case SESSION_ANSWERED:
+        break;
+    }
 
-    switch (ping_tty(ttyfd, reply, NULL, cprtimeout)) {
+    switch (state) {
       case DEVICE_STATUS_UNKNOWN:
-        errno_copy = errno;
         message = "DEVICE_STATUS_UNKNOWN";
-        xerror("unable to query the terminal");
         break;
       case DEVICE_OFFLINE:
         message = "DEVICE_OFFLINE";
@@ -628,7 +1102,10 @@ static int print_tty_status(int ttyfd, double cprtimeout)
         break;
     }
 
-    if ((result = puts(message) != EOF && fflush(stdout))) {
+    if ((result = (puts(message) == EOF ||
+        (show_rtt && rtt >= 0 && printf("RTT=%.6f\n", rtt) < 0) ||
+        fflush(stdout)))) {
+
         xerror("write error");
     }
 
@@ -671,6 +1148,7 @@ int main(int argc, char **argv)
     action_et action = ACTION_HUP_DETECTOR;
     double deadline = 0.200;
     int exit_status = EXIT_SUCCESS;
+    int show_rtt = 0;
     double timeout = 10;
     int ttyfd = -1;
     char ttypath[PATH_MAX] = "/dev/tty";
@@ -684,11 +1162,12 @@ int main(int argc, char **argv)
 
     exit_status = EXIT_BAD_USAGE;
 
-    while ((opt = getopt(argc, argv, "+1F:fhr:t:")) != -1) {
+    while ((opt = getopt(argc, argv, "+1F:fhRr:t:")) != -1) {
         switch (opt) {
           case '1': action = ACTION_ONE_SHOT_QUERY;     break;
           case 'f': action = ACTION_FLOW_CONTROL_ONLY;  break;
           case 'h': action = ACTION_HUP_DETECTOR;       break;
+          case 'R': show_rtt = 1;                       break;
 
           case 'F':
             if (strlen(optarg) <= (sizeof(ttypath) - 1)) {
@@ -762,7 +1241,7 @@ int main(int argc, char **argv)
         if (command) {
             errorf("unexpected non-option arguments");
         } else {
-            exit_status = print_tty_status(ttyfd, deadline);
+            exit_status = print_tty_status(ttyfd, deadline, show_rtt);
         }
     }
 